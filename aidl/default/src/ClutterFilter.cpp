@@ -0,0 +1,81 @@
+#include "ClutterFilter.h"
+
+namespace aidl::vendor::infineon::radar {
+
+bool ClutterFilter::isConfiguredFor(size_t nAntennas, size_t nChirps, size_t nSamples) const
+{
+    return mNumAntennas == nAntennas && mNumChirps == nChirps && mNumSamples == nSamples;
+}
+
+void ClutterFilter::configure(size_t nAntennas, size_t nChirps, size_t nSamples)
+{
+    if (! isConfiguredFor(nAntennas, nChirps, nSamples))
+    {
+        mNumAntennas = nAntennas;
+        mNumChirps = nChirps;
+        mNumSamples = nSamples;
+        mBackground.assign(nAntennas * nChirps * nSamples, 0.0f);
+        mBackground.shrink_to_fit();
+    }
+    reset();
+}
+
+void ClutterFilter::reset()
+{
+    mPrimed = false;
+}
+
+void ClutterFilter::release()
+{
+    mNumAntennas = 0;
+    mNumChirps = 0;
+    mNumSamples = 0;
+    mBackground.clear();
+    mBackground.shrink_to_fit();
+    reset();
+}
+
+void ClutterFilter::apply(float* frame)
+{
+    if (mNumSamples == 0)
+        return;
+    const float alpha = mAlpha;
+    const float invNumSamples = 1.0f / static_cast<float>(mNumSamples);
+    const size_t nChirpsTotal = mNumAntennas * mNumChirps;
+    // Chirps are contiguous in both the frame and the background, so each inner loop is a single
+    // unit-stride pass that the compiler turns into SIMD code.
+    for (size_t iChirp = 0; iChirp < nChirpsTotal; ++iChirp)
+    {
+        float* __restrict chirp = frame + iChirp * mNumSamples;
+        float* __restrict background = mBackground.data() + iChirp * mNumSamples;
+
+        float sum = 0.0f;
+        // explicit hint allows reordering of the float reduction, otherwise it stays scalar
+#pragma clang loop vectorize(enable)
+        for (size_t i = 0; i < mNumSamples; ++i)
+            sum += chirp[i];
+        const float mean = sum * invNumSamples;
+
+        if (! mPrimed)
+        {
+            for (size_t i = 0; i < mNumSamples; ++i)
+            {
+                background[i] = chirp[i] - mean;
+                chirp[i] = 0.0f;
+            }
+        }
+        else
+        {
+            // background += alpha * (x - background), where (x - background) is the output itself
+            for (size_t i = 0; i < mNumSamples; ++i)
+            {
+                const float filtered = chirp[i] - mean - background[i];
+                chirp[i] = filtered;
+                background[i] += alpha * filtered;
+            }
+        }
+    }
+    mPrimed = true;
+}
+
+} // namespace aidl::vendor::infineon::radar
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace aidl::vendor::infineon::radar {
+
+/**
+ * Streaming static clutter removal for raw frames laid out as
+ * "num_antennas" x "num_chirps_per_frame" x "num_samples_per_chirp" (see FrameData.aidl).
+ *
+ * For every chirp of every antenna it:
+ *   - subtracts the mean of the chirp (DC offset),
+ *   - subtracts the exponential moving average of that chirp over previous frames (static background),
+ *   - updates the background with weight alpha.
+ *
+ * Background buffers are allocated in configure(), apply() works in place and does not allocate.
+ * The first frame after configure() or reset() primes the background and thus comes out as zeros.
+ *
+ * Not thread safe, meant to be owned by the data acquisition thread.
+ */
+class ClutterFilter final {
+public:
+    static constexpr float DEFAULT_ALPHA = 0.1f;
+
+    static bool isValidAlpha(float alpha) { return alpha > 0.0f && alpha <= 1.0f; }
+
+    float alpha() const { return mAlpha; }
+    void setAlpha(float alpha) { mAlpha = alpha; }
+
+    bool isConfiguredFor(size_t nAntennas, size_t nChirps, size_t nSamples) const;
+    void configure(size_t nAntennas, size_t nChirps, size_t nSamples); // allocates buffers if shape changed, forgets background
+    void reset(); // forgets background, keeps buffers
+    void release(); // frees buffers, configure() must be called before next apply()
+    void apply(float* frame); // frame must have the shape passed to configure()
+
+private:
+    float mAlpha = DEFAULT_ALPHA;
+    size_t mNumAntennas = 0;
+    size_t mNumChirps = 0;
+    size_t mNumSamples = 0;
+    bool mPrimed = false;
+    std::vector<float> mBackground; // same layout as the frame
+};
+
+} // namespace aidl::vendor::infineon::radar
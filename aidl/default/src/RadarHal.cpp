@@ -36,6 +36,41 @@ using namespace std::chrono_literals;
 
 ndk::ScopedAStatus RadarHal::subscribe(const std::shared_ptr<IRawDataListener>& in_listener,
     const SensorConfig& in_config, int64_t* out_subscription_id)
+{
+    return addListener(mRawDataListeners, in_listener, in_config, out_subscription_id);
+}
+
+ndk::ScopedAStatus RadarHal::subscribeClutterFiltered(const std::shared_ptr<IRawDataListener>& in_listener,
+    const SensorConfig& in_config, float in_alpha, int64_t* out_subscription_id)
+{
+    if (! ClutterFilter::isValidAlpha(in_alpha))
+    {
+        LOG(ERROR) << "Provided alpha " << in_alpha << " is out of range (0, 1], aborting subscription";
+        *out_subscription_id = -1;
+        return ndk::ScopedAStatus::ok();
+    }
+
+    // filtered frames are shared, so all clutter filtered listeners must agree on alpha
+    if (! mClutterFilteredListeners.empty() && in_alpha != mClutterFilterAlpha)
+    {
+        LOG(ERROR) << "Provided alpha " << in_alpha << " is different to the active one (" << mClutterFilterAlpha
+                << ") used by other clutter filtered listeners, aborting subscription";
+        *out_subscription_id = -1;
+        return ndk::ScopedAStatus::ok();
+    }
+
+    // must happen before the listener is added, so that acquisition thread never filters a frame for it
+    // with background (or alpha) of a previous filtered session
+    if (mClutterFilteredListeners.empty())
+    {
+        mClutterFilterAlpha = in_alpha;
+        mClutterFilterResetRequested = true;
+    }
+    return addListener(mClutterFilteredListeners, in_listener, in_config, out_subscription_id);
+}
+
+ndk::ScopedAStatus RadarHal::addListener(ListenerMap& listeners, const std::shared_ptr<IRawDataListener>& in_listener,
+    const SensorConfig& in_config, int64_t* out_subscription_id)
 {
     if (in_listener == nullptr)
     {
@@ -45,7 +80,7 @@ ndk::ScopedAStatus RadarHal::subscribe(const std::shared_ptr<IRawDataListener>&
     }
       
     // refuse to subscribe if other listeners exist and use different config
-    if (! mRawDataListeners.empty() && in_config != mCurrentConfig)
+    if (hasListeners() && in_config != mCurrentConfig)
     {
         LOG(ERROR) << "Provided configuration is different to the active one used by other active listeners, aborting subscription";
         // TODO (would be nice to have) print the diff between configs
@@ -55,7 +90,7 @@ ndk::ScopedAStatus RadarHal::subscribe(const std::shared_ptr<IRawDataListener>&
 
     // if this is a first listener, connect sensor, set config, start data acquisition
     printActiveListeners();
-    if (mRawDataListeners.empty())
+    if (! hasListeners())
     {
         mCurrentConfig = in_config;
         if (! connectSensor())
@@ -76,7 +111,7 @@ ndk::ScopedAStatus RadarHal::subscribe(const std::shared_ptr<IRawDataListener>&
     // FIXME better id generation! https://trello.com/c/a8CT7GWL/57-better-id-generation-for-subscriptions
     *out_subscription_id = static_cast<int64_t>(rand()) << 32 | rand();
     LOG(DEBUG) << "Adding listener 0x" << std::hex << *out_subscription_id << std::dec << " ...";
-    mRawDataListeners[*out_subscription_id] = in_listener;
+    listeners[*out_subscription_id] = in_listener;
 
     LOG(DEBUG) << "Subscription successful. Generated subscription id = 0x" << std::hex << *out_subscription_id << std::dec;
     return ndk::ScopedAStatus::ok();
@@ -84,17 +119,23 @@ ndk::ScopedAStatus RadarHal::subscribe(const std::shared_ptr<IRawDataListener>&
 
 ndk::ScopedAStatus RadarHal::unsubscribe(int64_t subscription_id)
 {
-    auto it = mRawDataListeners.find(subscription_id);
-    if (it == mRawDataListeners.end())
+    ListenerMap* listeners = &mRawDataListeners;
+    auto it = listeners->find(subscription_id);
+    if (it == listeners->end())
+    {
+        listeners = &mClutterFilteredListeners;
+        it = listeners->find(subscription_id);
+    }
+    if (it == listeners->end())
     {
         LOG(ERROR) << "Could not find subscription with id 0x" << std::hex << subscription_id << std::dec << ". Cannot unsubscribe.";
         printActiveListeners();
         return ndk::ScopedAStatus::ok();
     }
     LOG(DEBUG) << "Removing subscription 0x" << std::hex << subscription_id << std::dec << " ...";
-    mRawDataListeners.erase(it);
+    listeners->erase(it);
     printActiveListeners();
-    if (mRawDataListeners.empty())
+    if (! hasListeners())
     {
         stopDataAcquisition();
         disconnectSensor();
@@ -107,6 +148,7 @@ ndk::ScopedAStatus RadarHal::unsubscribeAll()
 {
     LOG(DEBUG) << "Removing all listeners...";
     mRawDataListeners.clear();
+    mClutterFilteredListeners.clear();
     printActiveListeners();
     stopDataAcquisition();
     disconnectSensor();
@@ -146,9 +188,19 @@ binder_status_t RadarHal::dump(int fd, const char** /* args */, uint32_t /* numA
     dprintf(fd, "Registered listeners: %s\n", mRawDataListeners.empty() ? "none" : "");
     for (const auto& [id, listener] : mRawDataListeners)
         dprintf(fd, "\tclientId = %lx\n", id);
+    dprintf(fd, "Registered clutter filtered listeners: %s\n", mClutterFilteredListeners.empty() ? "none" : "");
+    if (! mClutterFilteredListeners.empty())
+        dprintf(fd, "\talpha = %g\n", mClutterFilterAlpha.load());
+    for (const auto& [id, listener] : mClutterFilteredListeners)
+        dprintf(fd, "\tclientId = %lx\n", id);
     return STATUS_OK;
 }
 
+bool RadarHal::hasListeners() const
+{
+    return ! mRawDataListeners.empty() || ! mClutterFilteredListeners.empty();
+}
+
 bool RadarHal::connectSensor()
 {
     // TODO lock_guard with mutex to avoid races when multiple subscribers are present
@@ -242,11 +294,13 @@ void RadarHal::disconnectSensor()
 
 void RadarHal::printActiveListeners() const
 {
-    if (! mRawDataListeners.empty())
+    if (hasListeners())
     {
-        LOG(DEBUG) << mRawDataListeners.size() << " listener(s) active:";
+        LOG(DEBUG) << mRawDataListeners.size() + mClutterFilteredListeners.size() << " listener(s) active:";
         for (const auto& [id, listener] : mRawDataListeners)
             LOG(DEBUG) << "\t0x" << std::hex << id << std::dec;
+        for (const auto& [id, listener] : mClutterFilteredListeners)
+            LOG(DEBUG) << "\t0x" << std::hex << id << std::dec << " (clutter filtered)";
     }
     else
     {
@@ -268,6 +322,9 @@ void RadarHal::startDataAcquisition()
         mRawDataAqcuisitionThread = std::thread([this]()
         {
             ifx_Cube_R_t* raw_frame = nullptr;
+            ClutterFilter clutterFilter; // buffers are allocated only while there are clutter filtered listeners
+            bool wasFiltering = false;
+            FrameData filteredFrame = {}; // reused across frames to avoid reallocation
             LOG(DEBUG) << "Raw data acquisition started";
             const std::chrono::seconds SILENCE_TIME = 5s;
             auto lastTimePrintedFps = std::chrono::system_clock::now();
@@ -286,6 +343,8 @@ void RadarHal::startDataAcquisition()
                     LOG(INFO) << "Sensor is connected again, resuming data acquisition";
                     lastTimePrintedFps = std::chrono::system_clock::now();
                     numFramesSinceLastFpsPrint = 0;
+                    // background from before the outage is stale
+                    mClutterFilterResetRequested = true;
                 }
                 else
                 {
@@ -313,13 +372,36 @@ void RadarHal::startDataAcquisition()
                             numFramesSinceLastFpsPrint = 0;
                         }
                     }
-                    if (mRawDataListeners.empty())
+                    if (! hasListeners())
                         LOG(WARNING) << "Got data, but there are no listeners to notify!";
                     for (const auto& [id, listener] : mRawDataListeners)
                     {
                         listener->onFrameReceived(frame);
                         // LOG(VERBOSE) << "Notified listener 0x" << std::hex << id << std::dec << " ...";
                     }
+                    // filter once, share the result with all clutter filtered listeners
+                    const bool isFiltering = ! mClutterFilteredListeners.empty();
+                    if (isFiltering)
+                    {
+                        // buffers are sized by the first frame of a filtered session, the config stays the same
+                        // while this thread runs, so this allocates at most once per session
+                        const bool resetRequested = mClutterFilterResetRequested.exchange(false);
+                        if (! wasFiltering || resetRequested || ! clutterFilter.isConfiguredFor(nAntennas, nChirps, nSamples))
+                        {
+                            clutterFilter.setAlpha(mClutterFilterAlpha);
+                            clutterFilter.configure(nAntennas, nChirps, nSamples);
+                        }
+                        filteredFrame.data.assign(frame.data.begin(), frame.data.end());
+                        clutterFilter.apply(filteredFrame.data.data());
+                        for (const auto& [id, listener] : mClutterFilteredListeners)
+                            listener->onFrameReceived(filteredFrame);
+                    }
+                    else if (wasFiltering)
+                    {
+                        clutterFilter.release();
+                        filteredFrame.data = {};
+                    }
+                    wasFiltering = isFiltering;
                 }
             }
             ifx_cube_destroy_r(raw_frame);
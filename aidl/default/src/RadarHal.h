@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ClutterFilter.h"
 #include "ifxAvian/DeviceControl.h"
 
 #include <aidl/vendor/infineon/radar/BnRadarSdk.h>
@@ -14,17 +15,27 @@ namespace aidl::vendor::infineon::radar {
 class RadarHal : public BnRadarSdk {
 public:
     ndk::ScopedAStatus subscribe(const std::shared_ptr<IRawDataListener>& in_listener, const SensorConfig& in_config, int64_t* out_subscription_id) override;
+    ndk::ScopedAStatus subscribeClutterFiltered(const std::shared_ptr<IRawDataListener>& in_listener, const SensorConfig& in_config, float in_alpha, int64_t* out_subscription_id) override;
     ndk::ScopedAStatus unsubscribe(int64_t subscription_id) override;
     ndk::ScopedAStatus unsubscribeAll() override;
     binder_status_t dump(int fd, const char** args, uint32_t numArgs) override;
 
 private:
+    using ListenerMap = std::unordered_map<int64_t, std::shared_ptr<IRawDataListener>>;
+
     ifx_Avian_Device_t* mDeviceHandle = nullptr; // must be reset to nullptr when device is not connected
     SensorConfig mCurrentConfig = {}; // there could be only one active config on the sensor
-    std::unordered_map<int64_t, std::shared_ptr<IRawDataListener>> mRawDataListeners; // all listeners must use same config
+    ListenerMap mRawDataListeners; // all listeners must use same config
+    ListenerMap mClutterFilteredListeners; // same as above, and all of them share the output of one ClutterFilter
+    // ClutterFilter itself lives in acquisition thread, these are handed over to it with the next frame
+    std::atomic<float> mClutterFilterAlpha = ClutterFilter::DEFAULT_ALPHA;
+    std::atomic_bool mClutterFilterResetRequested = false; // also applies mClutterFilterAlpha
     std::atomic_bool mStopRawDataAcquisition = true;
     std::thread mRawDataAqcuisitionThread;
 
+    ndk::ScopedAStatus addListener(ListenerMap& listeners, const std::shared_ptr<IRawDataListener>& in_listener,
+        const SensorConfig& in_config, int64_t* out_subscription_id);
+    bool hasListeners() const;
     bool connectSensor();
     void connectSensorUntilSuccess(); // will block forever until successfully connected
     void disconnectSensor();
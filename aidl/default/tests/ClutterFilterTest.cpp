@@ -0,0 +1,132 @@
+#include "ClutterFilter.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace aidl::vendor::infineon::radar {
+
+TEST(ClutterFilterTest, FirstFrameIsZeros)
+{
+    ClutterFilter filter;
+    filter.configure(2, 3, 4);
+    std::vector<float> frame(2 * 3 * 4);
+    for (size_t i = 0; i < frame.size(); ++i)
+        frame[i] = static_cast<float>(i * i);
+    filter.apply(frame.data());
+    for (float value : frame)
+        EXPECT_FLOAT_EQ(value, 0.0f);
+}
+
+TEST(ClutterFilterTest, RemovesDcOffsetAndUpdatesBackground)
+{
+    ClutterFilter filter;
+    filter.setAlpha(0.5f);
+    filter.configure(1, 1, 4);
+
+    std::vector<float> first = {1, 2, 3, 4};
+    filter.apply(first.data()); // background = {-1.5, -0.5, 0.5, 1.5}
+
+    // same shape, different DC offset: nothing but static clutter, thus fully removed
+    std::vector<float> second = {11, 12, 13, 14};
+    filter.apply(second.data());
+    for (float value : second)
+        EXPECT_FLOAT_EQ(value, 0.0f);
+
+    // DC removed: {-2, -1, 0, 3}, minus background
+    std::vector<float> third = {1, 2, 3, 6};
+    filter.apply(third.data());
+    EXPECT_FLOAT_EQ(third[0], -0.5f);
+    EXPECT_FLOAT_EQ(third[1], -0.5f);
+    EXPECT_FLOAT_EQ(third[2], -0.5f);
+    EXPECT_FLOAT_EQ(third[3], 1.5f);
+
+    // background moved by alpha * output: {-1.75, -0.75, 0.25, 2.25}
+    std::vector<float> fourth = {1, 2, 3, 6};
+    filter.apply(fourth.data());
+    EXPECT_FLOAT_EQ(fourth[0], -0.25f);
+    EXPECT_FLOAT_EQ(fourth[1], -0.25f);
+    EXPECT_FLOAT_EQ(fourth[2], -0.25f);
+    EXPECT_FLOAT_EQ(fourth[3], 0.75f);
+}
+
+TEST(ClutterFilterTest, ChirpsAreFilteredIndependently)
+{
+    ClutterFilter filter;
+    filter.setAlpha(1.0f);
+    filter.configure(2, 2, 2); // 4 chirps of 2 samples
+    std::vector<float> first = {0, 2, 10, 10, -4, 4, 7, 9};
+    filter.apply(first.data());
+
+    std::vector<float> second = {0, 4, 10, 10, -4, 4, 9, 7};
+    filter.apply(second.data());
+    const std::vector<float> expected = {-1, 1, 0, 0, 0, 0, 2, -2};
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_FLOAT_EQ(second[i], expected[i]) << "at index " << i;
+}
+
+TEST(ClutterFilterTest, ResetPrimesAgain)
+{
+    ClutterFilter filter;
+    filter.configure(1, 1, 2);
+    std::vector<float> frame = {0, 2};
+    filter.apply(frame.data());
+
+    frame = {5, -5};
+    filter.reset();
+    filter.apply(frame.data());
+    EXPECT_FLOAT_EQ(frame[0], 0.0f);
+    EXPECT_FLOAT_EQ(frame[1], 0.0f);
+
+    // background comes from the frame after reset
+    frame = {5, -5};
+    filter.apply(frame.data());
+    EXPECT_FLOAT_EQ(frame[0], 0.0f);
+    EXPECT_FLOAT_EQ(frame[1], 0.0f);
+}
+
+TEST(ClutterFilterTest, ConfigurePrimesAgainAndTracksShape)
+{
+    ClutterFilter filter;
+    EXPECT_TRUE(filter.isConfiguredFor(0, 0, 0));
+    filter.configure(1, 2, 3);
+    EXPECT_TRUE(filter.isConfiguredFor(1, 2, 3));
+    EXPECT_FALSE(filter.isConfiguredFor(1, 3, 2));
+
+    std::vector<float> frame = {0, 1, 2, 3, 4, 5};
+    filter.apply(frame.data());
+    frame = {0, 3, 0, 0, 0, 0};
+    filter.configure(1, 2, 3); // same shape, still starts over
+    filter.apply(frame.data());
+    for (float value : frame)
+        EXPECT_FLOAT_EQ(value, 0.0f);
+
+    filter.configure(1, 1, 2);
+    EXPECT_TRUE(filter.isConfiguredFor(1, 1, 2));
+    frame = {3, 1};
+    filter.apply(frame.data());
+    EXPECT_FLOAT_EQ(frame[0], 0.0f);
+    EXPECT_FLOAT_EQ(frame[1], 0.0f);
+}
+
+TEST(ClutterFilterTest, ReleasedFilterLeavesFrameUntouched)
+{
+    ClutterFilter filter;
+    filter.configure(1, 1, 2);
+    filter.release();
+    EXPECT_TRUE(filter.isConfiguredFor(0, 0, 0));
+    std::vector<float> frame = {3, 1};
+    filter.apply(frame.data());
+    EXPECT_FLOAT_EQ(frame[0], 3.0f);
+    EXPECT_FLOAT_EQ(frame[1], 1.0f);
+}
+
+TEST(ClutterFilterTest, ValidatesAlpha)
+{
+    EXPECT_FALSE(ClutterFilter::isValidAlpha(0.0f));
+    EXPECT_FALSE(ClutterFilter::isValidAlpha(-0.1f));
+    EXPECT_FALSE(ClutterFilter::isValidAlpha(1.1f));
+    EXPECT_TRUE(ClutterFilter::isValidAlpha(1.0f));
+    EXPECT_TRUE(ClutterFilter::isValidAlpha(ClutterFilter::DEFAULT_ALPHA));
+}
+
+} // namespace aidl::vendor::infineon::radar
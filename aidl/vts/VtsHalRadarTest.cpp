@@ -33,6 +33,7 @@
 #include <iostream>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace aidl::vendor::infineon::radar {
 
@@ -59,7 +60,7 @@ class RadarSdkAidl : public testing::Test {
     std::shared_ptr<IRadarSdk> radarSdk_;
 };
 
-TEST_F(RadarSdkAidl, RawDataCallbackIsCalled)
+SensorConfig defaultConfig()
 {
     SensorConfig config = {};
     config.sample_rate_Hz = 2000000;
@@ -76,6 +77,12 @@ TEST_F(RadarSdkAidl, RawDataCallbackIsCalled)
     config.hp_cutoff_Hz = 80000;
     config.aaf_cutoff_Hz = 500000;
     config.mimo_mode = 0; // IFX_MIMO_OFF
+    return config;
+}
+
+TEST_F(RadarSdkAidl, RawDataCallbackIsCalled)
+{
+    SensorConfig config = defaultConfig();
     int64_t subscription_id = -1;
 
     auto callback = ndk::SharedRefBase::make<MockListener>();
@@ -106,6 +113,86 @@ TEST_F(RadarSdkAidl, RawDataCallbackIsCalled)
     ASSERT_OK(radarSdk_->unsubscribe(subscription_id));
 }
 
+TEST_F(RadarSdkAidl, ClutterFilteredFramesFollowContract)
+{
+    SensorConfig config = defaultConfig();
+    int64_t subscription_id = -1;
+    const size_t nSamples = config.num_samples_per_chirp;
+    const size_t frameSize = 3 * config.num_chirps_per_frame * nSamples;
+
+    auto callback = ndk::SharedRefBase::make<MockListener>();
+    // data comes from another thread, we need to wait for it and keep the test running
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<FrameData> frames;
+    EXPECT_CALL(*callback, onFrameReceived)
+        .WillRepeatedly(testing::Invoke(
+            [&mutex, &cv, &frames](const FrameData& frame) {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (frames.size() < 2)
+                    frames.push_back(frame);
+                cv.notify_one();
+                return ndk::ScopedAStatus::ok();
+            }));
+
+    // act
+    ASSERT_OK(radarSdk_->subscribeClutterFiltered(callback, config, 0.1f, &subscription_id));
+    EXPECT_TRUE(subscription_id > 0);
+
+    // wait until two frames arrive (with timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        bool timeout = ! cv.wait_for(lock, std::chrono::seconds(1), [&frames] { return frames.size() == 2; });
+        EXPECT_FALSE(timeout);
+    }
+    ASSERT_OK(radarSdk_->unsubscribe(subscription_id));
+
+    // assert
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_EQ(frames.size(), 2u);
+    ASSERT_EQ(frames[0].data.size(), frameSize);
+    ASSERT_EQ(frames[1].data.size(), frameSize);
+    // first frame primes the background
+    for (float value : frames[0].data)
+        ASSERT_EQ(value, 0.0f);
+    // DC offset is removed from every chirp
+    for (size_t iChirp = 0; iChirp < frameSize / nSamples; ++iChirp)
+    {
+        float sum = 0.0f;
+        for (size_t iSample = 0; iSample < nSamples; ++iSample)
+            sum += frames[1].data[iChirp * nSamples + iSample];
+        EXPECT_NEAR(sum, 0.0f, 1e-3f) << "chirp " << iChirp;
+    }
+}
+
+TEST_F(RadarSdkAidl, ClutterFilteredSubscriptionRejectsDifferentAlpha)
+{
+    int64_t subscription_id = -1;
+    int64_t other_subscription_id = 0;
+    auto callback = ndk::SharedRefBase::make<MockListener>();
+    auto otherCallback = ndk::SharedRefBase::make<MockListener>();
+    EXPECT_CALL(*callback, onFrameReceived)
+        .WillRepeatedly(testing::Invoke([](const FrameData&) { return ndk::ScopedAStatus::ok(); }));
+    EXPECT_CALL(*otherCallback, onFrameReceived).Times(0);
+
+    ASSERT_OK(radarSdk_->subscribeClutterFiltered(callback, defaultConfig(), 0.1f, &subscription_id));
+    ASSERT_TRUE(subscription_id > 0);
+    ASSERT_OK(radarSdk_->subscribeClutterFiltered(otherCallback, defaultConfig(), 0.2f, &other_subscription_id));
+    EXPECT_EQ(other_subscription_id, -1);
+
+    ASSERT_OK(radarSdk_->unsubscribe(subscription_id));
+}
+
+TEST_F(RadarSdkAidl, ClutterFilteredSubscriptionRejectsInvalidAlpha)
+{
+    int64_t subscription_id = 0;
+    auto callback = ndk::SharedRefBase::make<MockListener>();
+    ASSERT_OK(radarSdk_->subscribeClutterFiltered(callback, defaultConfig(), 0.0f, &subscription_id));
+    EXPECT_EQ(subscription_id, -1);
+    ASSERT_OK(radarSdk_->subscribeClutterFiltered(callback, defaultConfig(), 1.5f, &subscription_id));
+    EXPECT_EQ(subscription_id, -1);
+}
+
 } // namespace aidl::vendor::infineon::radar
 
 int main(int argc, char** argv)